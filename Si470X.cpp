@@ -89,6 +89,10 @@ SI470X::SI470X (uint8_t sdio_pin, uint8_t sclk_pin, uint8_t sen_pin, uint8_t rst
 
 	_pass = 0; // init RDS vars
 	_filled = 0; // init RDS vars
+
+	_harvestList = NULL; // no harvest list yet
+	_harvestCount = 0;
+	_harvestNext = 0;
 }
 
 uint8_t SI470X::ready (void)
@@ -412,6 +416,148 @@ char *SI470X::getRDSdata (void)
 	return NULL;
 }
 
+// hand the harvester a list of stations (i.e. from a band scan) to visit.
+// only the channel of each entry needs to be set, everything else is cleared.
+void SI470X::setHarvest (RDS_STATION *list, uint8_t count)
+{
+	uint8_t n;
+
+	_harvestList = list;
+	_harvestCount = (count > 127) ? 127 : count; // index must fit harvestRDS() return
+	_harvestNext = 0;
+
+	for (n = 0; n < _harvestCount; n++) {
+		_clearStation (&_harvestList[n]);
+		_harvestList[n].misses = 0;
+	}
+}
+
+// let stations that were given up on (i.e. faded out for a while) back into
+// the round robin without losing what has been collected so far
+void SI470X::retryHarvest (void)
+{
+	uint8_t n;
+
+	for (n = 0; n < _harvestCount; n++) {
+		_harvestList[n].misses = 0;
+	}
+}
+
+// tune the next station in the harvest list that still needs RDS data and
+// stay there only while new data keeps coming in. the "no new data" window
+// is a number of intervals between good groups of still needed types (PS or
+// radiotext) as measured on this visit from the first such group, so slow or
+// noisy stations get more time and fast clean ones get left quickly. a visit
+// only counts as a miss if no needed groups arrived at all. the
+// chip is put in verbose RDS mode for the visit so that block errors are
+// reported (in standard mode BLERA...BLERD always read 0).
+// returns the list index of the station visited, or -1 if every station is
+// complete or has been given up on.
+int8_t SI470X::harvestRDS (void)
+{
+	RDS_STATION *st;
+	uint32_t start, last, now, window, firstGood, firstNeed;
+	uint16_t good, need, prevB, prevC, prevD;
+	uint8_t n, idx, fresh, result, verbose;
+
+	st = NULL;
+	idx = 0;
+	n = _harvestCount;
+
+	while (n--) { // round robin to the next station worth a visit
+		idx = _harvestNext;
+		_harvestNext = ((_harvestNext + 1) % _harvestCount);
+		if (((_harvestList[idx].flags & RDS_COMPLETE) != RDS_COMPLETE) && (_harvestList[idx].misses < RDS_MAX_MISSES)) {
+			st = &_harvestList[idx];
+			break;
+		}
+	}
+
+	if (st == NULL) {
+		return -1; // nothing left to collect
+	}
+
+	setChannel (st->channel);
+	_pass = 0; // new station, don't let getRDSdata() mix in old segments
+	_filled = 0;
+
+	_readRegisters (_REGISTERS); // read current chip registers
+	verbose = (_REGISTERS[POWERCFG] & RDSM) ? 1 : 0; // remember RDS mode
+	_REGISTERS[POWERCFG] |= RDSM; // set RDS verbose mode (report block errors)
+	_writeRegisters (_REGISTERS); // update chip registers
+
+	good = 0;
+	need = 0;
+	fresh = 0;
+	// skip whatever group is still sitting in the registers from before the tune
+	prevB = _REGISTERS[RDSB];
+	prevC = _REGISTERS[RDSC];
+	prevD = _REGISTERS[RDSD];
+	window = RDS_PROBE_MS;
+	start = last = firstGood = firstNeed = millis();
+
+	while ((st->flags & RDS_COMPLETE) != RDS_COMPLETE) {
+		now = millis();
+		if ((now - start) > RDS_MAX_DWELL) {
+			break; // let the other stations have a turn
+		}
+		if ((now - last) > window) {
+			break; // nothing new for a while
+		}
+
+		_readRegisters (_REGISTERS); // read current chip registers
+		if (! (_REGISTERS[STATUSRSSI] & RDSR)) {
+			continue;
+		}
+		// RDSR stays up for a while, don't count the same group twice
+		if ((_REGISTERS[RDSB] == prevB) && (_REGISTERS[RDSC] == prevC) && (_REGISTERS[RDSD] == prevD)) {
+			continue;
+		}
+		prevB = _REGISTERS[RDSB];
+		prevC = _REGISTERS[RDSC];
+		prevD = _REGISTERS[RDSD];
+
+		result = _harvestGroup (st);
+
+		if (result & RDS_GOOD) {
+			if (! good++) {
+				firstGood = now;
+				last = now; // RDS is in sync, start the stall clock here
+			}
+			if (result & RDS_NEED) {
+				if (! need++) {
+					firstNeed = now;
+				}
+			}
+			// wait RDS_STALL_GROUPS intervals of needed groups for something
+			// new, going by all good groups until that rate can be measured
+			if (need > 1) {
+				window = (((now - firstNeed) / (need - 1)) * RDS_STALL_GROUPS);
+			} else if (good > 1) {
+				window = (((now - firstGood) / (good - 1)) * RDS_STALL_GROUPS);
+			} else {
+				window = RDS_MIN_WINDOW;
+			}
+			window = (window < RDS_MIN_WINDOW) ? RDS_MIN_WINDOW : window;
+		}
+
+		if (result & RDS_NEW) {
+			last = now;
+			fresh = 1;
+		}
+	}
+
+	(fresh || need) ? st->misses = 0 : st->misses++; // skip stations that stop paying off
+
+	if (! verbose) {
+		_readRegisters (_REGISTERS); // read current chip registers
+		_REGISTERS[POWERCFG] &= ~RDSM; // back to RDS standard mode for getRDSdata()
+		_writeRegisters (_REGISTERS); // update chip registers
+	}
+
+	return idx;
+}
+
 
 
 //////////////////////////////////////////////////////////////////////
@@ -454,6 +600,170 @@ void SI470X::_readRegisters (uint16_t *_REGS)
 	}
 }
 
+// reset the RDS cache of a harvest list entry (channel and misses are kept)
+void SI470X::_clearStation (RDS_STATION *st)
+{
+	uint8_t idx;
+
+	st->pi = 0;
+	st->flags = 0;
+
+	idx = sizeof (st->ps);
+	while (idx--) {
+		st->ps[idx] = 0x20;
+	}
+	st->ps[sizeof (st->ps) - 1] = 0;
+
+	idx = sizeof (st->rt);
+	while (idx--) {
+		st->rt[idx] = 0x20;
+	}
+	st->rt[sizeof (st->rt) - 1] = 0;
+
+	st->_piNext = 0;
+	st->_psSeg = 0;
+	st->_rtSeg = 0;
+	st->_rtEnd = MAX_SEGMENTS;
+	st->_rtMode = 0xFF;
+}
+
+// decode the RDS group in the register shadow into a harvest list entry
+// returns RDS_GOOD if the blocks carrying the group's data were usable,
+// RDS_NEED if it was also of a type the entry still needs and RDS_NEW if
+// it added new data to the entry (0 if none of these)
+uint8_t SI470X::_harvestGroup (RDS_STATION *st)
+{
+	uint8_t blera, blerb, blerc, blerd, group, idx, addr, mode, width, n, c, ret, need;
+	uint16_t mask;
+
+	blera = ((_REGISTERS[STATUSRSSI] >> BLERA) & 0b11);
+	blerb = ((_REGISTERS[READCHANNEL] >> BLERB) & 0b11);
+	blerc = ((_REGISTERS[READCHANNEL] >> BLERC) & 0b11);
+	blerd = ((_REGISTERS[READCHANNEL] >> BLERD) & 0b11);
+
+	if (blerb > RDS_MAX_BLER) {
+		return 0; // can't trust the group type
+	}
+
+	ret = 0;
+	need = (st->flags & RDS_PI) ? 0 : 1; // any group carries the PI
+
+	if (blera <= RDS_MAX_BLER) {
+		if ((! (st->flags & RDS_PI)) || (st->pi != _REGISTERS[RDSA])) {
+			// a single (possibly miscorrected) block A doesn't change the PI
+			if (st->_piNext == _REGISTERS[RDSA]) {
+				if (st->flags & RDS_PI) {
+					_clearStation (st); // different station on this channel now
+					need = 1;
+				}
+				st->pi = _REGISTERS[RDSA];
+				st->flags |= RDS_PI;
+				ret |= RDS_NEW;
+			} else {
+				st->_piNext = _REGISTERS[RDSA];
+				return ret; // don't mix another station's data into the entry
+			}
+		}
+	}
+
+	group = ((_REGISTERS[RDSB] & 0xF000) >> 8); // get group base
+	group |= (_REGISTERS[RDSB] & 0x0800) ? 0x0B : 0x0A; // add in a/b code
+
+	// decide per group type which blocks have to be usable
+	if ((group == 0x0A) || (group == 0x0B)) { // PS in block D (0A block C is AF, not used)
+		if (blerd > RDS_MAX_BLER) {
+			return ret;
+		}
+		need |= (st->flags & RDS_PS) ? 0 : 1;
+	} else if (group == 0x2A) { // radiotext in blocks C and D
+		if ((blerc > RDS_MAX_BLER) || (blerd > RDS_MAX_BLER)) {
+			return ret;
+		}
+		need |= (st->flags & RDS_RT) ? 0 : 1;
+	} else if (group == 0x2B) { // radiotext in block D
+		if (blerd > RDS_MAX_BLER) {
+			return ret;
+		}
+		need |= (st->flags & RDS_RT) ? 0 : 1;
+	}
+	// other groups carry nothing we use besides the PI, block B was good
+
+	ret |= RDS_GOOD;
+	if (need) {
+		ret |= RDS_NEED;
+	}
+
+	// group 0A/0B: program service name, 2 chars per segment in block D
+	if ((group == 0x0A) || (group == 0x0B)) {
+		idx = (_REGISTERS[RDSB] & 0b11); // get segment index
+		if (! (st->_psSeg & (1UL << idx))) {
+			st->ps[(idx * 2) + 0] = (_REGISTERS[RDSD] >> 8);
+			st->ps[(idx * 2) + 1] = (_REGISTERS[RDSD] & 0x00FF);
+			st->_psSeg |= (1UL << idx);
+			if (st->_psSeg == 0b1111) {
+				st->flags |= RDS_PS;
+			}
+			ret |= RDS_NEW;
+		}
+	}
+
+	// group 2A/2B: radiotext, 4 chars (C+D) or 2 chars (D) per segment
+	if ((group == 0x2A) || (group == 0x2B)) {
+		mode = (_REGISTERS[RDSB] & TEXTAB) ? 1 : 0;
+		mode |= (group == 0x2B) ? 2 : 0;
+
+		if (st->_rtMode != mode) {
+			if (st->_rtMode != 0xFF) { // text changed, start over
+				idx = sizeof (st->rt);
+				while (idx--) {
+					st->rt[idx] = 0x20;
+				}
+				st->rt[sizeof (st->rt) - 1] = 0;
+				st->_rtSeg = 0;
+				st->_rtEnd = MAX_SEGMENTS;
+				st->flags &= ~RDS_RT;
+			}
+			st->_rtMode = mode;
+		}
+
+		if (st->flags & RDS_RT) {
+			return ret;
+		}
+
+		idx = (_REGISTERS[RDSB] & 0x000F); // get segment index
+		width = (group == 0x2A) ? (CHARS_PER_SEGMENT * VERSION_A_TEXT_SEGMENT_PER_GROUP) : (CHARS_PER_SEGMENT * VERSION_B_TEXT_SEGMENT_PER_GROUP);
+		addr = (idx * width);
+
+		if (! (st->_rtSeg & (1UL << idx))) {
+			for (n = 0; n < width; n++) {
+				if (group == 0x2A) {
+					c = (n < 2) ? (_REGISTERS[RDSC] >> ((1 - n) * 8)) : (_REGISTERS[RDSD] >> ((3 - n) * 8));
+				} else {
+					c = (_REGISTERS[RDSD] >> ((1 - n) * 8));
+				}
+				if (c == 0x0D) { // carriage return ends a short message
+					st->rt[addr + n] = 0;
+					if (st->_rtEnd > (idx + 1)) {
+						st->_rtEnd = (idx + 1);
+					}
+				} else {
+					st->rt[addr + n] = c;
+				}
+			}
+			st->_rtSeg |= (1UL << idx);
+			ret |= RDS_NEW;
+		}
+
+		mask = (st->_rtEnd >= MAX_SEGMENTS) ? 0xFFFF : ((1UL << st->_rtEnd) - 1);
+		if ((st->_rtSeg & mask) == mask) {
+			st->rt[st->_rtEnd * width] = 0; // version B text is only half as long
+			st->flags |= RDS_RT;
+		}
+	}
+
+	return ret;
+}
+
 // SPI mode 0 data transfer
 uint16_t SI470X::_spi_transfer (uint16_t data, uint8_t bits)
 {
@@ -123,6 +123,44 @@
 #define VERSION_A_TEXT_SEGMENT_PER_GROUP 2
 #define VERSION_B_TEXT_SEGMENT_PER_GROUP 1
 
+// RDS block B bits
+#define TEXTAB    (1UL << 0x04) // radiotext A/B (clear screen) flag
+
+// multi-station RDS harvester (all times in milliseconds)
+#define RDS_PROBE_MS     350 // give up on a visit if no good group shows up by then
+#define RDS_MIN_WINDOW   350 // shortest "no new data" window once groups arrive
+#define RDS_MAX_DWELL   2500 // hard limit per visit so the round robin keeps moving
+#define RDS_STALL_GROUPS   8 // still needed group intervals to wait for new data before leaving
+#define RDS_MAX_BLER       1 // worst usable block error level (0=none ... 3=uncorrectable)
+#define RDS_MAX_MISSES     3 // visits in a row with nothing new or needed before a station is skipped
+
+// _harvestGroup() return bits
+#define RDS_GOOD  (1UL << 0x00) // blocks carrying the group's data were usable
+#define RDS_NEED  (1UL << 0x01) // good group of a type the entry still needs
+#define RDS_NEW   (1UL << 0x02) // group added new data to the entry
+
+// RDS_STATION flags
+#define RDS_PI    (1UL << 0x00) // program identification received
+#define RDS_PS    (1UL << 0x01) // all 4 program service segments received
+#define RDS_RT    (1UL << 0x02) // whole radiotext message received
+#define RDS_COMPLETE (RDS_PI | RDS_PS | RDS_RT)
+
+// per channel RDS cache filled in by harvestRDS()
+typedef struct {
+	uint16_t channel; // FM channel, no decimal point (i.e. 104.1 is 1041)
+	uint16_t pi; // program identification code
+	char ps[9]; // program service name (station name)
+	char rt[MAX_MESSAGE_LENGTH + 1]; // radiotext
+	uint8_t flags; // RDS_PI, RDS_PS, RDS_RT
+	uint8_t misses; // visits in a row that brought nothing new or needed
+	// decoder state
+	uint16_t _piNext; // PI seen once, taken when it shows up again
+	uint8_t _psSeg; // ps segments received
+	uint16_t _rtSeg; // rt segments received
+	uint8_t _rtEnd; // rt segments in message (16 until a CR is seen)
+	uint8_t _rtMode; // rt version (bit 1) and A/B flag (bit 0), 0xFF = none yet
+} RDS_STATION;
+
 class SI470X
 {
 	public:
@@ -147,6 +185,9 @@ class SI470X
 		void setBlendadj (uint8_t);
 		char *getRDSdata (void);
 //		uint8_t getRDSdata (char *);
+		void setHarvest (RDS_STATION *, uint8_t); // max 127 stations, more are ignored
+		void retryHarvest (void); // give skipped stations another chance, keeps data
+		int8_t harvestRDS (void); // index of station visited, -1 if nothing left
 
 	private:
 		uint8_t _pass;
@@ -172,6 +213,11 @@ class SI470X
 		uint8_t _REGION=0;
 		uint16_t _REGISTERS[16]; // chip register shadow
 		char _rdsBuffer[MAX_MESSAGE_LENGTH];
+		RDS_STATION *_harvestList;
+		uint8_t _harvestCount;
+		uint8_t _harvestNext;
+		void _clearStation (RDS_STATION *);
+		uint8_t _harvestGroup (RDS_STATION *);
 		void _writeRegisters (uint16_t *);
 		void _readRegisters (uint16_t *);
 		uint16_t _spi_transfer (uint16_t, uint8_t);